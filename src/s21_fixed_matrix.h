@@ -0,0 +1,244 @@
+#ifndef SRC_S21_FIXED_MATRIX_H_
+#define SRC_S21_FIXED_MATRIX_H_
+
+// Compile-time sized matrix for small transforms (3x3, 4x4, ...).
+// Elements live inline in the object, so creating, copying or returning one
+// never touches the heap, and every loop has a constant trip count that the
+// compiler unrolls. Everything except the S21Matrix conversions is constexpr.
+// Indexing is unchecked; shape errors are compile errors instead.
+
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+// Calls body(0), ..., body(N - 1) as straight-line code, so the unrolling
+// does not depend on the optimization level of the including program.
+// flatten inlines the bodies too, which -O2 would leave as calls.
+template <typename Body, int... I>
+__attribute__((flatten)) constexpr void S21UnrollImpl(
+    Body& body, std::integer_sequence<int, I...>) {
+  (body(I), ...);
+}
+template <int N, typename Body>
+constexpr void S21Unroll(Body body) {
+  S21UnrollImpl(body, std::make_integer_sequence<int, N>());
+}
+
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "matrix dimensions must be positive");
+
+ public:
+  static constexpr int getRows() { return R; }
+  static constexpr int getCols() { return C; }
+
+  constexpr S21FixedMatrix() : data_{} {}
+  // Row-major values, missing trailing elements are zero
+  constexpr S21FixedMatrix(std::initializer_list<double> values) : data_{} {
+    if (values.size() > static_cast<std::size_t>(R * C)) {
+      throw std::length_error("Error: matrix size is wrong");
+    }
+    int k = 0;
+    for (double value : values) {
+      data_[k++] = value;
+    }
+  }
+  explicit S21FixedMatrix(const S21Matrix& other) : data_{} {
+    if (other.rows_ != R || other.cols_ != C) {
+      throw std::length_error("Error: matrix size is wrong");
+    }
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        data_[i * C + j] = other.matrix_[i][j];
+      }
+    }
+  }
+  S21Matrix ToMatrix() const {
+    S21Matrix result(R, C);
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        result.matrix_[i][j] = data_[i * C + j];
+      }
+    }
+    return result;
+  }
+
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const {
+    bool res = true;
+    for (int k = 0; k < R * C; k++) {
+      if (Abs(data_[k] - other.data_[k]) >= 1e-7) {
+        res = false;
+      }
+    }
+    return res;
+  }
+  constexpr void SumMatrix(const S21FixedMatrix& other) {
+    S21Unroll<R * C>([&](int k) { data_[k] += other.data_[k]; });
+  }
+  constexpr void SubMatrix(const S21FixedMatrix& other) {
+    S21Unroll<R * C>([&](int k) { data_[k] -= other.data_[k]; });
+  }
+  constexpr void MulNumber(const double num) {
+    S21Unroll<R * C>([&](int k) { data_[k] *= num; });
+  }
+  // The shape is part of the type, so only a square right operand keeps it
+  constexpr void MulMatrix(const S21FixedMatrix<C, C>& other) {
+    *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> result;
+    S21Unroll<R * C>([&](int k) { result(k % C, k / C) = data_[k]; });
+    return result;
+  }
+  // Matrix without the given row and column
+  constexpr S21FixedMatrix<R - 1, C - 1> Minor(int row, int col) const {
+    S21FixedMatrix<R - 1, C - 1> result;
+    S21Unroll<(R - 1) * (C - 1)>([&](int k) {
+      const int i = k / (C - 1), j = k % (C - 1);
+      result.data_[k] = data_[(i + (i >= row)) * C + j + (j >= col)];
+    });
+    return result;
+  }
+  constexpr S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "complements need a square matrix");
+    S21FixedMatrix result;
+    if constexpr (R == 1) {
+      result.data_[0] = 1.0;
+    } else {
+      S21Unroll<R * C>([&](int k) {
+        const double minor = this->Minor(k / C, k % C).Determinant();
+        result.data_[k] = (k / C + k % C) % 2 ? -minor : minor;
+      });
+    }
+    return result;
+  }
+  // Closed form up to 3x3, cofactor expansion of unrolled minors for 4x4,
+  // elimination with partial pivoting above that
+  constexpr double Determinant() const {
+    static_assert(R == C, "determinant needs a square matrix");
+    if constexpr (R == 1) {
+      return data_[0];
+    } else if constexpr (R == 2) {
+      return data_[0] * data_[3] - data_[1] * data_[2];
+    } else if constexpr (R == 3) {
+      return data_[0] * (data_[4] * data_[8] - data_[5] * data_[7]) -
+             data_[1] * (data_[3] * data_[8] - data_[5] * data_[6]) +
+             data_[2] * (data_[3] * data_[7] - data_[4] * data_[6]);
+    } else if constexpr (R == 4) {
+      double result = 0.0;
+      S21Unroll<C>([&](int j) {
+        const double term = data_[j] * this->Minor(0, j).Determinant();
+        result += j % 2 ? -term : term;
+      });
+      return result;
+    } else {
+      S21FixedMatrix a = *this;
+      double result = 1.0;
+      for (int k = 0; k < R && result != 0.0; k++) {
+        int pivot = k;
+        for (int i = k + 1; i < R; i++) {
+          if (Abs(a(i, k)) > Abs(a(pivot, k))) pivot = i;
+        }
+        if (pivot != k) {
+          for (int j = k; j < C; j++) {
+            const double t = a(k, j);
+            a(k, j) = a(pivot, j);
+            a(pivot, j) = t;
+          }
+          result = -result;
+        }
+        result *= a(k, k);
+        for (int i = k + 1; i < R && result != 0.0; i++) {
+          const double l = a(i, k) / a(k, k);
+          for (int j = k + 1; j < C; j++) {
+            a(i, j) -= l * a(k, j);
+          }
+        }
+      }
+      return result;
+    }
+  }
+  constexpr S21FixedMatrix InverseMatrix() const {
+    const double det = this->Determinant();
+    if (Abs(det) < 1e-7) {
+      throw std::length_error(
+          "Ooops!!! Determinant is 0, try again and please don't try to "
+          "break my code");
+    }
+    S21FixedMatrix result = this->CalcComplements().Transpose();
+    result.MulNumber(1.0 / det);
+    return result;
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    this->SumMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    this->SubMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix<C, C>& other) {
+    this->MulMatrix(other);
+    return *this;
+  }
+  constexpr S21FixedMatrix& operator*=(const double num) {
+    this->MulNumber(num);
+    return *this;
+  }
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    return this->EqMatrix(other);
+  }
+  constexpr double& operator()(int i, int j) { return data_[i * C + j]; }
+  constexpr const double& operator()(int i, int j) const {
+    return data_[i * C + j];
+  }
+
+ private:
+  template <int, int>
+  friend class S21FixedMatrix;
+  static constexpr double Abs(double x) { return x < 0.0 ? -x : x; }
+  // Attributes
+  double data_[R * C];
+};
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator+(S21FixedMatrix<R, C> lhs,
+                                         const S21FixedMatrix<R, C>& rhs) {
+  lhs.SumMatrix(rhs);
+  return lhs;
+}
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator-(S21FixedMatrix<R, C> lhs,
+                                         const S21FixedMatrix<R, C>& rhs) {
+  lhs.SubMatrix(rhs);
+  return lhs;
+}
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(S21FixedMatrix<R, C> lhs,
+                                         const double num) {
+  lhs.MulNumber(num);
+  return lhs;
+}
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(const double num,
+                                         S21FixedMatrix<R, C> rhs) {
+  rhs.MulNumber(num);
+  return rhs;
+}
+template <int R, int K, int C>
+constexpr S21FixedMatrix<R, C> operator*(const S21FixedMatrix<R, K>& lhs,
+                                         const S21FixedMatrix<K, C>& rhs) {
+  S21FixedMatrix<R, C> result;
+  S21Unroll<R * C>([&](int k) {
+    double acc = 0.0;
+    S21Unroll<K>([&](int p) { acc += lhs(k / C, p) * rhs(p, k % C); });
+    result(k / C, k % C) = acc;
+  });
+  return result;
+}
+
+#endif  // SRC_S21_FIXED_MATRIX_H_
@@ -0,0 +1,20 @@
+#ifndef SRC_S21_GEMM_H_
+#define SRC_S21_GEMM_H_
+
+// Instruction set used by the GEMM micro-kernel
+enum class S21GemmIsa { kScalar, kAvx2, kAvx512 };
+
+// C = beta * C + alpha * A * B, where A is m x k, B is k x n and C is m x n.
+// A(i, p) is read from a[i * rsa + p * csa] and B(p, j) from
+// b[p * rsb + j * csb], so transposed operands need no copy.
+// C is row-major with leading dimension ldc.
+void S21Gemm(int m, int n, int k, double alpha, const double* a, long rsa,
+             long csa, const double* b, long rsb, long csb, double beta,
+             double* c, long ldc);
+
+S21GemmIsa S21GemmActiveIsa();
+bool S21GemmIsaSupported(S21GemmIsa isa);
+// Forces the kernel (e.g. for tests); false if the CPU lacks the ISA
+bool S21GemmSetIsa(S21GemmIsa isa);
+
+#endif  // SRC_S21_GEMM_H_
@@ -0,0 +1,96 @@
+#ifndef SRC_S21_INSTRUMENT_H_
+#define SRC_S21_INSTRUMENT_H_
+
+// Optional per-operation counters, compiled in with -DS21_MATRIX_INSTRUMENT
+// (make INSTRUMENT=1). Every public operation then records its calls, wall
+// time and the matrix buffers allocated while it ran, split by the size of
+// its operand, and S21Instrument reports them. Without the flag the hooks
+// expand to nothing, and the queries return zeros. Compiled in, a call
+// costs two clock reads and a few relaxed atomic adds (~0.1 us in a VM), so
+// profile operations on small matrices with the benchmarks instead.
+//
+// Times are inclusive: GEMM called by MulMatrix counts in both. Allocations
+// go to the outermost operation running on the calling thread; those made
+// outside any operation (constructors called by the user) go to kOther.
+// The library and the code that includes its headers must agree on the flag.
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+enum class S21Op {
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kEqMatrix,
+  kTranspose,
+  kTransposeInPlace,
+  kDeterminant,
+  kCalcComplements,
+  kInverseMatrix,
+  kCopy,
+  kExpression,  // Fused elementwise expressions (a + b * 2.0, ...)
+  kGemm,        // Every matrix product, including a * b expressions
+  kSave,
+  kLoad,
+  kMap,
+  kMulMatrixFiles,
+  kOther,
+  kCount
+};
+
+struct S21OpStats {
+  std::uint64_t calls;
+  std::uint64_t nanoseconds;
+  std::uint64_t allocations;
+  std::uint64_t bytes;  // Allocated bytes
+};
+
+class S21Instrument {
+ public:
+  // Size class c holds operands of [2^c, 2^(c + 1)) elements
+  static constexpr int kSizeClasses = 40;
+
+  static constexpr bool Enabled() {
+#ifdef S21_MATRIX_INSTRUMENT
+    return true;
+#else
+    return false;
+#endif
+  }
+  static const char* Name(S21Op op);
+  static S21OpStats Get(S21Op op);
+  static S21OpStats Get(S21Op op, int size_class);
+  static void Reset();
+  // Table of every operation that was called, with its size classes
+  static void Dump(std::ostream& out);
+
+#ifdef S21_MATRIX_INSTRUMENT
+  // Times one operation from construction to destruction
+  class Scope {
+   public:
+    Scope(S21Op op, std::size_t elements);
+    ~Scope();
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    int op_, size_class_;
+    bool outermost_;
+    std::int64_t start_;
+  };
+  static void RecordAllocation(std::size_t bytes);
+#endif
+};
+
+#ifdef S21_MATRIX_INSTRUMENT
+#define S21_INSTRUMENT_OP(op, elements) \
+  S21Instrument::Scope s21_instrument_scope((op), (elements))
+#define S21_INSTRUMENT_ALLOC(bytes) S21Instrument::RecordAllocation(bytes)
+#else
+#define S21_INSTRUMENT_OP(op, elements) static_cast<void>(0)
+#define S21_INSTRUMENT_ALLOC(bytes) static_cast<void>(0)
+#endif
+
+#endif  // SRC_S21_INSTRUMENT_H_
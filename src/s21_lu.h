@@ -0,0 +1,41 @@
+#ifndef SRC_S21_LU_H_
+#define SRC_S21_LU_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting, P * A = L * U.
+// Factor once, then reuse it for the determinant, solves and the inverse.
+class S21LU {
+ public:
+  explicit S21LU(const S21Matrix& matrix);
+
+  int getSize() const { return size_; }
+  bool IsSingular() const { return singular_; }
+  // Some pivot is at most n * eps * max|a_ij|, so A is singular to working
+  // precision
+  bool IsNearlySingular() const;
+
+  double Determinant() const;
+  S21Matrix Solve(const S21Matrix& rhs) const;  // A * X = rhs, rhs is n x m
+  S21Matrix Inverse() const;
+  // adj(A): det(A) * A^-1, or for a nearly singular A the rank-one matrix
+  // built from its null vectors (zero when rank(A) <= n - 2)
+  S21Matrix Adjugate() const;
+
+ private:
+  // Attributes
+  int size_;
+  int sign_;               // Sign of the row permutation
+  bool singular_;          // A zero pivot was met
+  double tolerance_;       // Pivots up to this count as zero in Adjugate()
+  S21Matrix lu_;           // Unit L below the diagonal, U on and above it
+  std::vector<int> perm_;  // Row i of P * A is row perm_[i] of A
+  void Factor();
+  void SolveLower(S21Matrix& x) const;
+  void SolveUpper(S21Matrix& x) const;
+  S21Matrix SingularAdjugate() const;
+};
+
+#endif  // SRC_S21_LU_H_
@@ -0,0 +1,63 @@
+#ifndef SRC_S21_MATRIX_BATCH_H_
+#define SRC_S21_MATRIX_BATCH_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Many small matrices of one shape in a structure-of-arrays layout.
+// Matrices are grouped in blocks of kLanes; inside a block element (i, j)
+// of all kLanes matrices is contiguous, so one SIMD register holds the same
+// element of kLanes matrices and every instruction advances kLanes matrices
+// at once. Blocks are independent and are spread over the thread pool.
+// Unused lanes of the last block are zero and never exposed.
+class S21MatrixBatch {
+ public:
+  static constexpr int kLanes = 8;
+
+  int getCount() const { return count_; }
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+
+  S21MatrixBatch();
+  S21MatrixBatch(int count, int rows, int cols);
+  // All matrices must have the shape of the first one
+  explicit S21MatrixBatch(const std::vector<S21Matrix>& matrices);
+  S21MatrixBatch(const S21MatrixBatch& other);
+  S21MatrixBatch(S21MatrixBatch&& other) noexcept;
+  ~S21MatrixBatch();
+
+  S21Matrix Get(int index) const;
+  void Set(int index, const S21Matrix& matrix);
+
+  void SumMatrix(const S21MatrixBatch& other);
+  void SubMatrix(const S21MatrixBatch& other);
+  void MulNumber(const double num);
+  // Replaces every matrix with its product by the matching one of other
+  void MulMatrix(const S21MatrixBatch& other);
+  std::vector<double> Determinant() const;
+  // Throws if any of the matrices is singular
+  S21MatrixBatch InverseMatrix() const;
+
+  S21MatrixBatch& operator=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator=(S21MatrixBatch&& other) noexcept;
+  double& operator()(int index, int i, int j);
+  double operator()(int index, int i, int j) const;
+
+ private:
+  static constexpr std::size_t kAlignment = 64;
+  // Attributes
+  int count_;        // Matrices in the batch
+  int rows_, cols_;  // Shape of every matrix
+  int blocks_;       // Groups of kLanes matrices
+  double* data_;     // blocks_ * rows_ * cols_ * kLanes aligned doubles
+  std::size_t Size() const;
+  std::size_t Offset(int index, int i, int j) const;
+  void CheckShape(const S21MatrixBatch& other) const;
+  void CheckIndex(int index, int i, int j) const;
+  void Create(int count, int rows, int cols);
+  void Remove();
+  void Swap(S21MatrixBatch& other) noexcept;
+};
+
+#endif  // SRC_S21_MATRIX_BATCH_H_
@@ -0,0 +1,320 @@
+#ifndef SRC_S21_MATRIX_EXPR_H_
+#define SRC_S21_MATRIX_EXPR_H_
+
+// Lazy expression templates for S21Matrix, included from s21_matrix_oop.h.
+//
+// a + b, a - b, a * 2.0 and a * b build lightweight nodes instead of
+// matrices. Assigning a node to an S21Matrix evaluates the whole elementwise
+// tree in one fused loop without temporaries, split into row panels on the
+// library thread pool. Products are evaluated by GEMM, and `c = a * b + d`
+// or `c += a * b` become a single accumulating GEMM. a.TransposeView() is
+// never built when it feeds a product: GEMM reads it with swapped strides.
+// Nodes keep references to S21Matrix operands, so do not store them in
+// `auto` variables that outlive the operands.
+
+#include <stdexcept>
+
+#include "s21_gemm.h"
+#include "s21_instrument.h"
+#include "s21_thread_pool.h"
+
+// Matrices are held by reference, nested nodes by value
+template <typename E>
+struct S21ExprOperand {
+  using type = const E;
+};
+template <>
+struct S21ExprOperand<S21Matrix> {
+  using type = const S21Matrix&;
+};
+
+struct S21AddOp {
+  static constexpr double kSign = 1.0;
+  static double Apply(double a, double b) { return a + b; }
+};
+struct S21SubOp {
+  static constexpr double kSign = -1.0;
+  static double Apply(double a, double b) { return a - b; }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinary : public S21MatrixExpr<S21MatrixBinary<L, R, Op>> {
+ public:
+  S21MatrixBinary(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.getRows() != rhs.getRows() || lhs.getCols() != rhs.getCols()) {
+      throw std::length_error("Error: matrix size is wrong");
+    }
+  }
+  int getRows() const { return lhs_.getRows(); }
+  int getCols() const { return lhs_.getCols(); }
+  double Coeff(int i, int j) const {
+    return Op::Apply(lhs_.Coeff(i, j), rhs_.Coeff(i, j));
+  }
+  bool Aliases(const S21Matrix& m) const {
+    return lhs_.Aliases(m) || rhs_.Aliases(m);
+  }
+  bool Crosses(const S21Matrix& m) const {
+    return lhs_.Crosses(m) || rhs_.Crosses(m);
+  }
+  void Prepare() const {
+    lhs_.Prepare();
+    rhs_.Prepare();
+  }
+  const L& lhs() const { return lhs_; }
+  const R& rhs() const { return rhs_; }
+
+ private:
+  typename S21ExprOperand<L>::type lhs_;
+  typename S21ExprOperand<R>::type rhs_;
+};
+
+template <typename E>
+class S21MatrixScaled : public S21MatrixExpr<S21MatrixScaled<E>> {
+ public:
+  S21MatrixScaled(const E& expr, double num) : expr_(expr), num_(num) {}
+  int getRows() const { return expr_.getRows(); }
+  int getCols() const { return expr_.getCols(); }
+  double Coeff(int i, int j) const { return num_ * expr_.Coeff(i, j); }
+  bool Aliases(const S21Matrix& m) const { return expr_.Aliases(m); }
+  bool Crosses(const S21Matrix& m) const { return expr_.Crosses(m); }
+  void Prepare() const { expr_.Prepare(); }
+
+ private:
+  typename S21ExprOperand<E>::type expr_;
+  double num_;
+};
+
+// Transpose of a matrix, read in place through swapped indices
+class S21MatrixTransposed : public S21MatrixExpr<S21MatrixTransposed> {
+ public:
+  explicit S21MatrixTransposed(const S21Matrix& m) : m_(m) {}
+  int getRows() const { return m_.getCols(); }
+  int getCols() const { return m_.getRows(); }
+  double Coeff(int i, int j) const { return m_.Coeff(j, i); }
+  bool Aliases(const S21Matrix& m) const { return m_.Aliases(m); }
+  bool Crosses(const S21Matrix& m) const { return m_.Aliases(m); }
+  void Prepare() const {}
+  const S21Matrix& matrix() const { return m_; }
+
+ private:
+  const S21Matrix& m_;
+};
+
+// GEMM operand: element (i, j) is data[i * rs + j * cs]
+struct S21GemmOperand {
+  const double* data;
+  long rs, cs;
+};
+
+// Matrix product. Evaluated by S21Gemm straight into the destination when
+// the assignment allows it, otherwise materialized once by Prepare().
+template <typename L, typename R>
+class S21MatrixProduct : public S21MatrixExpr<S21MatrixProduct<L, R>> {
+ public:
+  S21MatrixProduct(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.getCols() != rhs.getRows()) {
+      throw std::length_error("Error: matrix size is wrong");
+    }
+  }
+  int getRows() const { return lhs_.getRows(); }
+  int getCols() const { return rhs_.getCols(); }
+  double Coeff(int i, int j) const { return result_.Coeff(i, j); }
+  bool Aliases(const S21Matrix& m) const {
+    return lhs_.Aliases(m) || rhs_.Aliases(m);
+  }
+  // Prepare() builds the product before anything is written
+  bool Crosses(const S21Matrix&) const { return false; }
+  void Prepare() const {
+    if (result_.matrix_ == nullptr) {
+      S21Matrix result(this->getRows(), this->getCols());
+      this->EvalTo(result, 1.0, 0.0);
+      result_.Swap(result);
+    }
+  }
+  // dst = beta * dst + alpha * lhs * rhs, dst must not alias the operands
+  void EvalTo(S21Matrix& dst, double alpha, double beta) const {
+    S21Matrix lhs_tmp, rhs_tmp;
+    const S21GemmOperand a = Materialize(lhs_, lhs_tmp);
+    const S21GemmOperand b = Materialize(rhs_, rhs_tmp);
+    S21Gemm(this->getRows(), this->getCols(), lhs_.getCols(), alpha, a.data,
+            a.rs, a.cs, b.data, b.rs, b.cs, beta, dst.data_, dst.stride_);
+  }
+
+ private:
+  static S21GemmOperand Materialize(const S21Matrix& m, S21Matrix&) {
+    return {m.data_, m.stride_, 1};
+  }
+  static S21GemmOperand Materialize(const S21MatrixTransposed& t, S21Matrix&) {
+    return {t.matrix().data_, 1, t.matrix().stride_};
+  }
+  template <typename E>
+  static S21GemmOperand Materialize(const E& expr, S21Matrix& tmp) {
+    tmp = expr;
+    return {tmp.data_, tmp.stride_, 1};
+  }
+  typename S21ExprOperand<L>::type lhs_;
+  typename S21ExprOperand<R>::type rhs_;
+  mutable S21Matrix result_;
+};
+
+template <typename L, typename R>
+S21MatrixBinary<L, R, S21AddOp> operator+(const S21MatrixExpr<L>& lhs,
+                                          const S21MatrixExpr<R>& rhs) {
+  return S21MatrixBinary<L, R, S21AddOp>(lhs.derived(), rhs.derived());
+}
+template <typename L, typename R>
+S21MatrixBinary<L, R, S21SubOp> operator-(const S21MatrixExpr<L>& lhs,
+                                          const S21MatrixExpr<R>& rhs) {
+  return S21MatrixBinary<L, R, S21SubOp>(lhs.derived(), rhs.derived());
+}
+template <typename L, typename R>
+S21MatrixProduct<L, R> operator*(const S21MatrixExpr<L>& lhs,
+                                 const S21MatrixExpr<R>& rhs) {
+  return S21MatrixProduct<L, R>(lhs.derived(), rhs.derived());
+}
+template <typename E>
+S21MatrixScaled<E> operator*(const S21MatrixExpr<E>& expr, double num) {
+  return S21MatrixScaled<E>(expr.derived(), num);
+}
+template <typename E>
+S21MatrixScaled<E> operator*(double num, const S21MatrixExpr<E>& expr) {
+  return S21MatrixScaled<E>(expr.derived(), num);
+}
+
+inline S21MatrixTransposed S21Matrix::TransposeView() const {
+  return S21MatrixTransposed(*this);
+}
+
+template <typename E>
+S21Matrix::S21Matrix(const S21MatrixExpr<E>& expr) {
+  this->NullingHandler();
+  this->Assign(expr.derived());
+}
+template <typename E>
+S21Matrix& S21Matrix::operator=(const S21MatrixExpr<E>& expr) {
+  this->Assign(expr.derived());
+  return *this;
+}
+template <typename E>
+S21Matrix& S21Matrix::operator+=(const S21MatrixExpr<E>& expr) {
+  this->Accumulate(expr.derived(), 1.0);
+  return *this;
+}
+template <typename E>
+S21Matrix& S21Matrix::operator-=(const S21MatrixExpr<E>& expr) {
+  this->Accumulate(expr.derived(), -1.0);
+  return *this;
+}
+
+// Elementwise trees: one pass, reading operands and writing *this in place.
+// Mapped matrices get a new owned buffer instead, as for a shape change.
+template <typename E>
+void S21Matrix::Assign(const E& expr) {
+  expr.Prepare();
+  if (this->rows_ != expr.getRows() || this->cols_ != expr.getCols() ||
+      this->IsMapped() || expr.Crosses(*this)) {
+    S21Matrix result(expr.getRows(), expr.getCols());
+    result.Assign(expr);
+    this->Swap(result);
+    return;
+  }
+  S21_INSTRUMENT_OP(S21Op::kExpression,
+                    static_cast<std::size_t>(this->rows_) * this->cols_);
+  S21ThreadPool::Instance().Run(
+      0, this->rows_, static_cast<long>(this->rows_) * this->cols_,
+      [this, &expr](int i0, int i1) {
+        for (int i = i0; i < i1; i++) {
+          double* row = this->matrix_[i];
+          for (int j = 0; j < this->cols_; j++) {
+            row[j] = expr.Coeff(i, j);
+          }
+        }
+      });
+}
+template <typename L, typename R>
+void S21Matrix::Assign(const S21MatrixProduct<L, R>& expr) {
+  if (expr.Aliases(*this) || this->IsMapped() ||
+      this->rows_ != expr.getRows() || this->cols_ != expr.getCols()) {
+    S21Matrix result(expr.getRows(), expr.getCols());
+    expr.EvalTo(result, 1.0, 0.0);
+    this->Swap(result);
+  } else {
+    expr.EvalTo(*this, 1.0, 0.0);
+  }
+}
+// x +- a * b: x is written first, then the product is accumulated onto it
+template <typename E, typename L, typename R, typename Op>
+void S21Matrix::Assign(
+    const S21MatrixBinary<E, S21MatrixProduct<L, R>, Op>& expr) {
+  if (expr.rhs().Aliases(*this)) {
+    this->Assign<S21MatrixBinary<E, S21MatrixProduct<L, R>, Op>>(expr);
+    return;
+  }
+  this->Assign(expr.lhs());
+  expr.rhs().EvalTo(*this, Op::kSign, 1.0);
+}
+// a * b +- x: +-x is written first, then the product is accumulated onto it
+template <typename L, typename R, typename E, typename Op>
+void S21Matrix::Assign(
+    const S21MatrixBinary<S21MatrixProduct<L, R>, E, Op>& expr) {
+  if (expr.lhs().Aliases(*this)) {
+    this->Assign<S21MatrixBinary<S21MatrixProduct<L, R>, E, Op>>(expr);
+    return;
+  }
+  this->Assign(S21MatrixScaled<E>(expr.rhs(), Op::kSign));
+  expr.lhs().EvalTo(*this, 1.0, 1.0);
+}
+template <typename L1, typename R1, typename L2, typename R2, typename Op>
+void S21Matrix::Assign(const S21MatrixBinary<S21MatrixProduct<L1, R1>,
+                                             S21MatrixProduct<L2, R2>, Op>&
+                           expr) {
+  using Expr = S21MatrixBinary<S21MatrixProduct<L1, R1>,
+                               S21MatrixProduct<L2, R2>, Op>;
+  if (expr.Aliases(*this)) {
+    this->Assign<Expr>(expr);
+    return;
+  }
+  this->Assign(expr.lhs());
+  expr.rhs().EvalTo(*this, Op::kSign, 1.0);
+}
+
+template <typename E>
+void S21Matrix::Accumulate(const E& expr, double sign) {
+  if (this->rows_ != expr.getRows() || this->cols_ != expr.getCols()) {
+    throw std::length_error("Error: matrix size is wrong");
+  }
+  if (expr.Crosses(*this)) {
+    this->Accumulate(S21Matrix(expr), sign);
+    return;
+  }
+  this->Unmap();
+  expr.Prepare();
+  S21_INSTRUMENT_OP(S21Op::kExpression,
+                    static_cast<std::size_t>(this->rows_) * this->cols_);
+  S21ThreadPool::Instance().Run(
+      0, this->rows_, static_cast<long>(this->rows_) * this->cols_,
+      [this, &expr, sign](int i0, int i1) {
+        for (int i = i0; i < i1; i++) {
+          double* row = this->matrix_[i];
+          for (int j = 0; j < this->cols_; j++) {
+            row[j] += sign * expr.Coeff(i, j);
+          }
+        }
+      });
+}
+template <typename L, typename R>
+void S21Matrix::Accumulate(const S21MatrixProduct<L, R>& expr, double sign) {
+  if (this->rows_ != expr.getRows() || this->cols_ != expr.getCols()) {
+    throw std::length_error("Error: matrix size is wrong");
+  }
+  if (expr.Aliases(*this)) {
+    S21Matrix product(expr.getRows(), expr.getCols());
+    expr.EvalTo(product, 1.0, 0.0);
+    this->Accumulate(product, sign);
+  } else {
+    this->Unmap();
+    expr.EvalTo(*this, sign, 1.0);
+  }
+}
+
+#endif  // SRC_S21_MATRIX_EXPR_H_
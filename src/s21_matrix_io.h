@@ -0,0 +1,113 @@
+#ifndef SRC_S21_MATRIX_IO_H_
+#define SRC_S21_MATRIX_IO_H_
+
+// Binary S21Matrix files.
+//
+// Layout: a 64-byte S21MatrixFileHeader, zero fill up to `alignment` bytes,
+// then rows * stride little-endian doubles, row-major. The stride is the
+// in-memory padded stride, so a file can be read straight into a matrix
+// buffer or mapped and used in place. The checksum covers the data area.
+//
+// S21Matrix::Save/Load/Map (declared in s21_matrix_oop.h) handle whole
+// matrices; the reader and writer below move row blocks, so matrices larger
+// than RAM can be produced and consumed piece by piece.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+struct S21MatrixFileHeader {
+  static constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint32_t kFloat64 = 1;  // IEEE-754 double
+  // Offset of the data: one page, so mapped rows keep their alignment
+  static constexpr std::uint64_t kAlignment = 4096;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint64_t rows, cols;
+  std::uint64_t stride;     // Doubles between consecutive rows
+  std::uint64_t alignment;  // Byte offset of the data area
+  std::uint64_t checksum;   // S21Checksum of the data area
+  std::uint64_t reserved;
+};
+static_assert(sizeof(S21MatrixFileHeader) == 64, "header must be 64 bytes");
+
+// 64-bit hash of a double stream (four xxHash64-style lanes, so it runs at
+// memory speed). Feeding the data in any split gives the same digest.
+class S21Checksum {
+ public:
+  void Update(const double* data, std::size_t count);
+  std::uint64_t Digest() const;
+
+ private:
+  std::uint64_t lanes_[4] = {0x60ea27eeadc0b5d6ULL, 0xc2b2ae3d27d4eb4fULL,
+                             0x0ULL, 0x61c8864e7a143579ULL};
+  std::uint64_t words_ = 0;
+};
+
+// Writes a rows x cols file from consecutive row blocks. The header is
+// written by Close() once all rows are in, so an interrupted file is never
+// mistaken for a valid one.
+class S21MatrixWriter {
+ public:
+  S21MatrixWriter(const std::string& path, int rows, int cols);
+  ~S21MatrixWriter();
+  S21MatrixWriter(const S21MatrixWriter&) = delete;
+  S21MatrixWriter& operator=(const S21MatrixWriter&) = delete;
+
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  int getPosition() const { return position_; }  // Rows written so far
+
+  // Appends all rows of block, which must have getCols() columns
+  void Write(const S21Matrix& block);
+  void Close();
+
+ private:
+  // Attributes
+  std::string path_;
+  int fd_;
+  int rows_, cols_;
+  int stride_;  // File stride in doubles
+  int position_;
+  S21Checksum checksum_;
+  void WriteRows(const double* data, std::size_t count);
+};
+
+// Reads row blocks of a file in any order. A full front-to-back pass checks
+// the checksum when its last row is read.
+class S21MatrixReader {
+ public:
+  explicit S21MatrixReader(const std::string& path);
+  ~S21MatrixReader();
+  S21MatrixReader(const S21MatrixReader&) = delete;
+  S21MatrixReader& operator=(const S21MatrixReader&) = delete;
+
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
+  int getPosition() const { return position_; }  // Next row to read
+
+  // Reads the next min(count, rows left) rows into block, reusing its
+  // buffer when it is large enough; false once all rows are read
+  bool Read(S21Matrix& block, int count);
+  void Seek(int row);
+
+ private:
+  friend class S21Matrix;  // Map() reuses the header checks and the fd
+  // Attributes
+  std::string path_;
+  int fd_;
+  int rows_, cols_;
+  int stride_;
+  int position_;
+  std::uint64_t offset_;    // Byte offset of the data area
+  std::uint64_t expected_;  // Checksum from the header
+  bool verify_;             // Reading front to back since row 0
+  S21Checksum checksum_;
+};
+
+#endif  // SRC_S21_MATRIX_IO_H_
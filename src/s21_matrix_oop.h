@@ -2,12 +2,33 @@
 #define SRC_MATRIX_H_
 
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <new>
+#include <string>
+#include <utility>
 
-class S21Matrix {
+class S21Matrix;
+template <typename L, typename R, typename Op>
+class S21MatrixBinary;
+template <typename L, typename R>
+class S21MatrixProduct;
+template <int R, int C>
+class S21FixedMatrix;
+class S21MatrixTransposed;
+
+// Base of every lazy matrix expression (see s21_matrix_expr.h)
+template <typename Derived>
+class S21MatrixExpr {
+ public:
+  const Derived& derived() const { return static_cast<const Derived&>(*this); }
+};
+
+class S21Matrix : public S21MatrixExpr<S21Matrix> {
  public:
-  int getRows() { return rows_; }
-  int getCols() { return cols_; }
+  int getRows() const { return rows_; }
+  int getCols() const { return cols_; }
   double** getMatrix() { return matrix_; }
   // void setElement(int row, int col, double value) { matrix_[row][col] =
   // value; }
@@ -17,7 +38,10 @@ class S21Matrix {
   S21Matrix();  // Default constructor
   S21Matrix(int rows, int columns);
   S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other);
+  S21Matrix(S21Matrix&& other) noexcept;
+  // Evaluates a lazy expression such as a + b * 2.0 in one fused pass
+  template <typename E>
+  S21Matrix(const S21MatrixExpr<E>& expr);
   ~S21Matrix();  // Destructor
 
   bool EqMatrix(const S21Matrix& other);
@@ -25,37 +49,112 @@ class S21Matrix {
   void SubMatrix(const S21Matrix& other);
   void MulNumber(const double num);
   void MulMatrix(const S21Matrix& other);
+  // this * other^T without building other^T
+  void MulMatrix(const S21MatrixTransposed& other);
 
   S21Matrix Transpose();
+  // Square matrices are transposed without allocating
+  void TransposeInPlace();
+  // Lazy transpose: products read it through GEMM strides, assignment
+  // uses the blocked kernel
+  S21MatrixTransposed TransposeView() const;
   S21Matrix CalcComplements();
   double Determinant();
   S21Matrix InverseMatrix();
 
-  S21Matrix operator+=(const S21Matrix& other);
-  S21Matrix operator-=(const S21Matrix& other);
-  S21Matrix operator*=(const S21Matrix& other);
-  S21Matrix operator*=(const double num);
-
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double num);
+  S21Matrix& operator+=(const S21Matrix& other);
+  S21Matrix& operator-=(const S21Matrix& other);
+  S21Matrix& operator*=(const S21Matrix& other);
+  S21Matrix& operator*=(const double num);
+  template <typename E>
+  S21Matrix& operator+=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21Matrix& operator-=(const S21MatrixExpr<E>& expr);
 
+  // operator+, operator- and operator* are lazy, see s21_matrix_expr.h
   S21Matrix& operator=(const S21Matrix& other);
+  S21Matrix& operator=(S21Matrix&& other) noexcept;
+  template <typename E>
+  S21Matrix& operator=(const S21MatrixExpr<E>& expr);
   bool operator==(const S21Matrix& other);
   double& operator()(int i, int j);
   double& operator()(int i, int j) const;
 
+  // Binary files (format in s21_matrix_io.h). Load reads into a new buffer
+  // and checks the checksum. Map wraps the file pages without copying or
+  // reading them, so only the header and size are checked: kReadOnly
+  // shares the pages (writing an element through operator() faults),
+  // kCopyOnWrite gives private copies of the pages that are written to.
+  // Operations that write the whole matrix (assignments, SumMatrix,
+  // MulNumber, TransposeInPlace, SetRows, ...) first move a mapped matrix
+  // into an owned buffer, so the file is never written.
+  enum class MapMode { kReadOnly, kCopyOnWrite };
+  void Save(const std::string& path) const;
+  static S21Matrix Load(const std::string& path);
+  static S21Matrix Map(const std::string& path, MapMode mode);
+  bool IsMapped() const { return mapping_ != nullptr; }
+  // Out-of-core product of two files into a third, holding about
+  // memory_bytes of blocks in RAM at a time
+  static void MulMatrixFiles(const std::string& lhs, const std::string& rhs,
+                             const std::string& result,
+                             std::size_t memory_bytes);
+
+  // Expression interface
+  double Coeff(int i, int j) const {
+    return data_[static_cast<std::size_t>(i) * stride_ + j];
+  }
+  bool Aliases(const S21Matrix& other) const { return this == &other; }
+  // True if (i, j) of the expression reads other elements of m, so it
+  // cannot be written into m in place
+  bool Crosses(const S21Matrix&) const { return false; }
+  void Prepare() const {}
+
  private:
+  friend class S21LU;
+  friend class S21MatrixBatch;
+  friend class S21MatrixReader;
+  friend class S21MatrixWriter;
+  template <int R, int C>
+  friend class S21FixedMatrix;
+  template <typename L, typename R>
+  friend class S21MatrixProduct;
+  // Alignment of the data buffer and of every padded row, in bytes
+  static constexpr std::size_t kAlignment = 64;
   // Attributes
   int rows_, cols_;  // Rows and columns
-  double** matrix_;  // Pointer to the memory where the matrix is allocated
+  int stride_;       // Distance between rows in doubles (cols_ + padding)
+  int capacity_;     // Rows the buffer can hold without reallocation
+  double** matrix_;  // Row pointers into data_, kept for getMatrix()
+  double* data_;     // Single aligned row-major buffer of rows_ * stride_
+  // File mapping data_ points into; then matrix_ is allocated on its own
+  void* mapping_;
+  std::size_t mapping_bytes_;
+  static int PaddedStride(int cols);
   void RemoveMatrix();
   void NullingHandler();
-  double GetDeterminant();
   void Copy(const S21Matrix& other);
+  void CopyBlock(const S21Matrix& other, int rows, int cols);
+  void Swap(S21Matrix& other) noexcept;
+  void Unmap();
   void CreateMatrix(int rows, int columns);
-  void GetMatrix(int row, int col, const S21Matrix& tmp);
+  template <typename E>
+  void Assign(const E& expr);
+  void Assign(const S21MatrixTransposed& expr);
+  template <typename L, typename R>
+  void Assign(const S21MatrixProduct<L, R>& expr);
+  template <typename E, typename L, typename R, typename Op>
+  void Assign(const S21MatrixBinary<E, S21MatrixProduct<L, R>, Op>& expr);
+  template <typename L, typename R, typename E, typename Op>
+  void Assign(const S21MatrixBinary<S21MatrixProduct<L, R>, E, Op>& expr);
+  template <typename L1, typename R1, typename L2, typename R2, typename Op>
+  void Assign(const S21MatrixBinary<S21MatrixProduct<L1, R1>,
+                                    S21MatrixProduct<L2, R2>, Op>& expr);
+  template <typename E>
+  void Accumulate(const E& expr, double sign);
+  template <typename L, typename R>
+  void Accumulate(const S21MatrixProduct<L, R>& expr, double sign);
 };
 
+#include "s21_matrix_expr.h"
+
 #endif  // SRC_MATRIX_H_
\ No newline at end of file
@@ -0,0 +1,77 @@
+#ifndef SRC_S21_THREAD_POOL_H_
+#define SRC_S21_THREAD_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool owned by the library. Operations split their
+// output into disjoint ranges (rows, tiles, columns) and hand them to Run(),
+// so every element is computed by the same arithmetic whatever the thread
+// count is, and results are bit-for-bit deterministic.
+class S21ThreadPool {
+ public:
+  static S21ThreadPool& Instance();
+
+  // Total threads including the caller; 0 means hardware concurrency.
+  // Must not be called while operations are running.
+  void SetThreadCount(int count);
+  int getThreadCount() const { return thread_count_; }
+  // Minimal work (flops or touched elements) that is worth going parallel
+  void SetParallelThreshold(long work) { threshold_ = work; }
+  long getParallelThreshold() const { return threshold_; }
+
+  // Calls body(begin, end) over disjoint chunks covering [begin, end).
+  // Runs inline when work is below the threshold, the pool has one thread
+  // or the caller is already inside a parallel region.
+  template <typename Body>
+  void Run(int begin, int end, long work, const Body& body) {
+    this->RunRange(begin, end, work, &body,
+                   [](const void* context, int range_begin, int range_end) {
+                     (*static_cast<const Body*>(context))(range_begin,
+                                                          range_end);
+                   });
+  }
+
+  ~S21ThreadPool();
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+
+ private:
+  // Type-erased body: no std::function, so dispatch never allocates
+  using Callback = void (*)(const void* context, int begin, int end);
+  struct Job;
+  struct Task {
+    Job* job;
+    int begin, end;
+  };
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  S21ThreadPool();
+  void RunRange(int begin, int end, long work, const void* context,
+                Callback callback);
+  void Start(int count);
+  void Stop();
+  void WorkerLoop(int index);
+  bool TryRunTask(int index);
+  static void Execute(const Task& task);
+
+  // Attributes
+  int thread_count_;
+  std::atomic<long> threshold_;
+  std::vector<std::unique_ptr<Queue>> queues_;  // [0] is shared by callers
+  std::vector<std::thread> workers_;
+  std::atomic<long> pending_;  // Queued tasks not yet taken
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  bool stop_;
+};
+
+#endif  // SRC_S21_THREAD_POOL_H_
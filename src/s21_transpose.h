@@ -0,0 +1,18 @@
+#ifndef SRC_S21_TRANSPOSE_H_
+#define SRC_S21_TRANSPOSE_H_
+
+// Cache-oblivious transpose. The matrix is split in halves along its longer
+// side until a block fits in L1, and blocks are moved as 8x8 tiles
+// transposed in registers (one zmm per row on AVX-512, four 4x4 ymm blocks
+// on AVX2). The kernel follows the ISA selected for GEMM. Results larger
+// than L2 are written with streaming stores. Row bands are spread over the
+// thread pool.
+
+// B = A^T, where A is rows x cols with leading dimension lda and B is
+// cols x rows with leading dimension ldb; A and B must not overlap
+void S21Transpose(int rows, int cols, const double* a, long lda, double* b,
+                  long ldb);
+// A = A^T for a square n x n matrix, without extra memory
+void S21TransposeInPlace(int n, double* a, long lda);
+
+#endif  // SRC_S21_TRANSPOSE_H_